@@ -171,6 +171,12 @@ bool ImageState::generateBoardstate(cv::Mat& img) {
 
 bool ImageState::generateBoardState(std::vector<Cluster>& redClusters, std::vector<Cluster>& blueClusters) {
     bool success = true;
+    // Clear last frame so the same object can be reused for each frame
+    boardState = "";
+    redPiecesOnBoard.clear();
+    bluePiecesOnBoard.clear();
+    redPiecesOffBoard.clear();
+    bluePiecesOffBoard.clear();
     // Red Pieces
     for(Cluster& c : redClusters) {
         CheckersPiece cp;
@@ -75,6 +75,7 @@ class ImageState {
         // Returns the number of blue kings off the board
         int countBlueKingsOffBoard();
         // Creates the board state from a bunch of clusters
+        // Replaces the board string and piece lists from the previous frame
         bool generateBoardState(std::vector<Cluster>& redClusters, std::vector<Cluster>& blueClusters);
         // changes the board state to match the image
         // The state still changes even if false is returned
@@ -0,0 +1,74 @@
+/**
+ * @file SharedBoardState.h
+ * @author EMNEM
+ * @brief 
+ * @version 0.1
+ * @date 2022-10-02
+ * 
+ * Layout of the board state shared memory region used by StatePublisher
+ * and StateReader. Has no OpenCV dependency so readers can include it alone.
+ */
+
+#ifndef SHARED_BOARD_STATE_H
+#define SHARED_BOARD_STATE_H
+
+#include <atomic>
+#include <cstdint>
+
+#define SHARED_STATE_DEFAULT_NAME "/checkers_board_state"
+#define SHARED_STATE_MAGIC 0x43484b52u
+#define SHARED_STATE_VERSION 1
+// 8 rows of 8 squares plus a newline each, same as ImageState::boardState
+#define SHARED_STATE_BOARD_LEN 72
+#define SHARED_STATE_MAX_PIECES 32
+
+// Region atomics must not fall back to a mutex, they live in shared memory
+static_assert(sizeof(int) == sizeof(uint32_t), "ATOMIC_INT_LOCK_FREE must describe uint32_t");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "std::atomic<uint32_t> must be lock free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "std::atomic<uint32_t> must have no extra state");
+
+struct SharedPiece {
+    int32_t x;
+    int32_t y;
+    uint8_t onBoard;
+    uint8_t isBlue;
+    uint8_t isKing;
+    uint8_t pad;
+};
+
+// count is how many entries of pieces are filled, total is how many were
+// recognised, total > count means the list was cut to SHARED_STATE_MAX_PIECES
+struct SharedPieceList {
+    uint32_t count;
+    uint32_t total;
+    SharedPiece pieces[SHARED_STATE_MAX_PIECES];
+};
+
+// One recognised state, copied out whole by readers
+struct SharedBoardStateData {
+    // Increments once per published state, starts at 1
+    uint64_t sequence;
+    // steady_clock time in nanoseconds of when the frame was captured
+    int64_t frameTimestampNs;
+    uint8_t isValid;
+    char boardState[SHARED_STATE_BOARD_LEN + 1];
+    SharedPieceList redPiecesOnBoard;
+    SharedPieceList bluePiecesOnBoard;
+    SharedPieceList redPiecesOffBoard;
+    SharedPieceList bluePiecesOffBoard;
+};
+
+// Whole shared memory region, single writer and any number of readers
+// magic is stored last with release once the header is set up
+// seq is odd while the writer is in the middle of updating data
+// The atomics are never constructed, this relies on ftruncate zero filling
+// the region and a zeroed lock free atomic being a valid 0
+struct SharedBoardStateRegion {
+    // Must stay the first member, publisher clears everything after it
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    std::atomic<uint32_t> seq;
+    SharedBoardStateData data;
+};
+
+#endif
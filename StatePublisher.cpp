@@ -0,0 +1,162 @@
+/**
+ * @file StatePublisher.cpp
+ * @author EMNEM
+ * @brief 
+ * @version 0.1
+ * @date 2022-10-02
+ * 
+ * Writer side of the board state seqlock
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "StatePublisher.h"
+
+// Copies a piece vector into a fixed size list, extra pieces are dropped
+// but still counted in total
+static void copyPieces(SharedPieceList& dest, std::vector<CheckersPiece>& src) {
+    uint32_t count = 0;
+    for(CheckersPiece& p : src) {
+        if(count == SHARED_STATE_MAX_PIECES) {
+            break;
+        }
+        SharedPiece& sp = dest.pieces[count];
+        sp.x = p.x;
+        sp.y = p.y;
+        sp.onBoard = p.onBoard;
+        sp.isBlue = p.isBlue;
+        sp.isKing = p.isKing;
+        sp.pad = 0;
+        count++;
+    }
+    dest.count = count;
+    dest.total = src.size();
+}
+
+StatePublisher::StatePublisher() {
+    sequence = 0;
+    region = nullptr;
+    shmFd = -1;
+}
+
+StatePublisher::~StatePublisher() {
+    close();
+}
+
+bool StatePublisher::open(const std::string& name) {
+    close();
+    int fd = -1;
+    for(int i = 0; i < PUBLISHER_OPEN_RETRIES && fd == -1; i++) {
+        fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+        if(fd == -1) {
+            std::cout << "Could not open shared memory: " << name << "\n";
+            return false;
+        }
+        // Seqlock only works with a single writer, refuse if another publisher has it
+        if(flock(fd, LOCK_EX | LOCK_NB) == -1) {
+            std::cout << "Shared memory already has a publisher: " << name << "\n";
+            ::close(fd);
+            return false;
+        }
+        // Previous publisher may have unlinked the object while we waited on the lock,
+        // readers can no longer find it by name so open the new one instead
+        struct stat st;
+        if(fstat(fd, &st) == -1 || st.st_nlink == 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    if(fd == -1) {
+        std::cout << "Shared memory kept being unlinked: " << name << "\n";
+        return false;
+    }
+    if(ftruncate(fd, sizeof(SharedBoardStateRegion)) == -1) {
+        std::cout << "Could not size shared memory: " << name << "\n";
+        ::close(fd);
+        return false;
+    }
+    void* mem = mmap(nullptr, sizeof(SharedBoardStateRegion), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(mem == MAP_FAILED) {
+        std::cout << "Could not map shared memory: " << name << "\n";
+        ::close(fd);
+        return false;
+    }
+    region = static_cast<SharedBoardStateRegion*>(mem);
+    shmFd = fd;
+    shmName = name;
+    if(region->magic.load(std::memory_order_acquire) == SHARED_STATE_MAGIC && region->version == SHARED_STATE_VERSION) {
+        // Reopened after a restart, carry on from the last sequence so readers see new states
+        sequence = region->data.sequence;
+    }
+    else {
+        // Fresh regions are zero filled by ftruncate, but one left by a different
+        // version still has its old contents, hide it from readers and clear it
+        sequence = 0;
+        region->magic.store(0, std::memory_order_release);
+        std::memset(reinterpret_cast<char*>(region) + sizeof(region->magic), 0,
+                    sizeof(SharedBoardStateRegion) - sizeof(region->magic));
+        region->version = SHARED_STATE_VERSION;
+        region->magic.store(SHARED_STATE_MAGIC, std::memory_order_release);
+    }
+    return true;
+}
+
+void StatePublisher::close(bool unlink) {
+    if(region != nullptr) {
+        if(unlink) {
+            // Readers still mapping this object see the bad magic and reopen by name
+            region->magic.store(0, std::memory_order_release);
+            shm_unlink(shmName.c_str());
+        }
+        munmap(region, sizeof(SharedBoardStateRegion));
+        region = nullptr;
+    }
+    if(shmFd != -1) {
+        // Releases the publisher lock
+        ::close(shmFd);
+        shmFd = -1;
+    }
+}
+
+bool StatePublisher::publish(ImageState& state, int64_t frameTimestampNs) {
+    if(region == nullptr) {
+        return false;
+    }
+    if(state.boardState.size() != SHARED_STATE_BOARD_LEN) {
+        std::cout << "Not publishing malformed board state of length " << state.boardState.size() << "\n";
+        return false;
+    }
+    // Odd count if the last writer died mid update, skip to even first
+    uint32_t seq = region->seq.load(std::memory_order_relaxed);
+    if(seq & 1) {
+        seq++;
+    }
+    // Mark as being written before touching any data
+    region->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    SharedBoardStateData& data = region->data;
+    sequence++;
+    data.sequence = sequence;
+    data.frameTimestampNs = frameTimestampNs;
+    data.isValid = state.isValidState;
+    std::memcpy(data.boardState, state.boardState.data(), SHARED_STATE_BOARD_LEN);
+    data.boardState[SHARED_STATE_BOARD_LEN] = '\0';
+    copyPieces(data.redPiecesOnBoard, state.redPiecesOnBoard);
+    copyPieces(data.bluePiecesOnBoard, state.bluePiecesOnBoard);
+    copyPieces(data.redPiecesOffBoard, state.redPiecesOffBoard);
+    copyPieces(data.bluePiecesOffBoard, state.bluePiecesOffBoard);
+    // Even again, readers can now use the data
+    region->seq.store(seq + 2, std::memory_order_release);
+    return true;
+}
+
+int64_t StatePublisher::now() {
+    auto t = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t).count();
+}
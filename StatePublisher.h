@@ -0,0 +1,46 @@
+/**
+ * @file StatePublisher.h
+ * @author EMNEM
+ * @brief 
+ * @version 0.1
+ * @date 2022-10-02
+ * 
+ * Publishes recognised board states to other processes through POSIX
+ * shared memory guarded by a seqlock
+ */
+
+#ifndef STATE_PUBLISHER_H
+#define STATE_PUBLISHER_H
+
+#include <cstdint>
+#include <string>
+#include "PieceRecognition.h"
+#include "SharedBoardState.h"
+
+#define PUBLISHER_OPEN_RETRIES 10
+
+class StatePublisher {
+    public:
+        StatePublisher();
+        ~StatePublisher();
+        // Creates or reopens the shared memory region, returns true if it worked
+        // Only one publisher may hold a region, a second open fails until the first closes
+        bool open(const std::string& name = SHARED_STATE_DEFAULT_NAME);
+        // Unmaps the region, set unlink to also remove it for all processes
+        // Unlinking tells readers to reopen by name once a new publisher starts
+        void close(bool unlink = false);
+        // Writes the state into shared memory, never blocks on readers
+        // Returns false without publishing if the board string is not 8 rows of 8
+        // frameTimestampNs should be steady_clock time of when the frame was taken
+        bool publish(ImageState& state, int64_t frameTimestampNs);
+        // Returns steady_clock time in nanoseconds, for frame timestamps
+        static int64_t now();
+        uint64_t sequence;
+    private:
+        SharedBoardStateRegion* region;
+        // Held open for the exclusive lock while publishing
+        int shmFd;
+        std::string shmName;
+};
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file StateReader.cpp
+ * @author EMNEM
+ * @brief 
+ * @version 0.1
+ * @date 2022-10-02
+ * 
+ * Reader side of the board state seqlock, no syscalls once opened
+ */
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "StateReader.h"
+
+StateReader::StateReader() {
+    lastSequence = 0;
+    region = nullptr;
+}
+
+StateReader::~StateReader() {
+    close();
+}
+
+bool StateReader::open(const std::string& name) {
+    close();
+    shmName = name;
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if(fd == -1) {
+        return false;
+    }
+    // Publisher creates the object before sizing it, touching a short mapping raises SIGBUS
+    struct stat st;
+    if(fstat(fd, &st) == -1 || st.st_size < (off_t)sizeof(SharedBoardStateRegion)) {
+        ::close(fd);
+        return false;
+    }
+    void* mem = mmap(nullptr, sizeof(SharedBoardStateRegion), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(mem == MAP_FAILED) {
+        return false;
+    }
+    region = static_cast<const SharedBoardStateRegion*>(mem);
+    if(region->magic.load(std::memory_order_acquire) != SHARED_STATE_MAGIC || region->version != SHARED_STATE_VERSION) {
+        // Publisher not finished setting up or is a different version
+        close();
+        return false;
+    }
+    return true;
+}
+
+void StateReader::close() {
+    if(region != nullptr) {
+        munmap(const_cast<SharedBoardStateRegion*>(region), sizeof(SharedBoardStateRegion));
+        region = nullptr;
+    }
+}
+
+bool StateReader::read(SharedBoardStateData& out) {
+    if(region == nullptr) {
+        return false;
+    }
+    for(int i = 0; i < STATE_READER_MAX_RETRIES; i++) {
+        uint32_t before = region->seq.load(std::memory_order_acquire);
+        if(before & 1) {
+            // Writer is mid update
+            continue;
+        }
+        std::memcpy(&out, &region->data, sizeof(SharedBoardStateData));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t after = region->seq.load(std::memory_order_relaxed);
+        if(before == after) {
+            // Copy was not torn
+            return out.sequence != 0;
+        }
+    }
+    return false;
+}
+
+bool StateReader::poll(SharedBoardStateData& out) {
+    if(region == nullptr || region->magic.load(std::memory_order_acquire) != SHARED_STATE_MAGIC
+       || region->version != SHARED_STATE_VERSION) {
+        // Region was unlinked or reset, new publisher may have made a new one under the same name
+        if(shmName.empty() || !open(shmName)) {
+            return false;
+        }
+        // New region restarts its sequence
+        lastSequence = 0;
+    }
+    if(!read(out) || out.sequence == lastSequence) {
+        return false;
+    }
+    lastSequence = out.sequence;
+    return true;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file StateReader.h
+ * @author EMNEM
+ * @brief 
+ * @version 0.1
+ * @date 2022-10-02
+ * 
+ * Reader side of the board state shared memory, for the game engine and
+ * arm controller. Does not need OpenCV.
+ */
+
+#ifndef STATE_READER_H
+#define STATE_READER_H
+
+#include <cstdint>
+#include <string>
+#include "SharedBoardState.h"
+
+#define STATE_READER_MAX_RETRIES 1000
+
+class StateReader {
+    public:
+        StateReader();
+        ~StateReader();
+        // Maps the region read only, returns false if publisher has not created it yet
+        bool open(const std::string& name = SHARED_STATE_DEFAULT_NAME);
+        // Unmaps the region
+        void close();
+        // Copies the latest state into out, returns false if nothing published
+        // yet or the writer kept getting in the way
+        bool read(SharedBoardStateData& out);
+        // Like read but only returns true if the state is newer than the last one returned
+        // Reopens by name if the publisher unlinked or reset the region or was not running at open
+        bool poll(SharedBoardStateData& out);
+        uint64_t lastSequence;
+    private:
+        const SharedBoardStateRegion* region;
+        std::string shmName;
+};
+
+#endif
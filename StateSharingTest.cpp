@@ -0,0 +1,118 @@
+/**
+ * @file StateSharingTest.cpp
+ * @author EMNEM
+ * @brief 
+ * @version 0.1
+ * @date 2022-10-02
+ * 
+ * Checks board states published by StatePublisher can be read back by StateReader
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sys/mman.h>
+#include "PieceRecognition.h"
+#include "StatePublisher.h"
+#include "StateReader.h"
+
+#define TEST_SHM_NAME "/checkers_board_state_test"
+
+// Prints message and returns false if condition does not hold
+static bool check(bool condition, const std::string& message) {
+    if(!condition) {
+        std::cout << "FAILED: " << message << "\n";
+    }
+    return condition;
+}
+
+// Makes a cluster that generateBoardState will turn into a piece at x, y
+static Cluster makeCluster(int x, int y) {
+    Cluster c;
+    c.x = x;
+    c.y = y;
+    c.isValid = true;
+    return c;
+}
+
+// Sets up an aligned 800x800 board with 100 pixel squares
+static void alignFakeBoard(ImageState& state) {
+    state.edgeX[0] = 0;
+    state.edgeX[1] = 800;
+    state.edgeY[0] = 0;
+    state.edgeY[1] = 800;
+    state.avgSquareWidth = 100;
+    state.avgSquareHeight = 100;
+}
+
+int main() {
+    bool ok = true;
+    // Remove any region left by a crashed run so this one starts zero filled
+    shm_unlink(TEST_SHM_NAME);
+    StatePublisher publisher;
+    if(!check(publisher.open(TEST_SHM_NAME), "publisher open")) {
+        return 1;
+    }
+    StateReader reader;
+    ok &= check(reader.open(TEST_SHM_NAME), "reader open");
+    SharedBoardStateData data;
+    ok &= check(!reader.poll(data), "poll before any publish");
+
+    // Frame 1, one red piece in the top left square
+    ImageState state;
+    alignFakeBoard(state);
+    std::vector<Cluster> redClusters = {makeCluster(50, 50)};
+    std::vector<Cluster> blueClusters;
+    state.isValidState = state.generateBoardState(redClusters, blueClusters);
+    ok &= check(publisher.publish(state, StatePublisher::now()), "publish frame 1");
+    ok &= check(reader.poll(data), "poll frame 1");
+    ok &= check(data.sequence == publisher.sequence, "frame 1 sequence");
+    ok &= check(data.isValid == 1, "frame 1 valid");
+    ok &= check(std::string(data.boardState) == state.boardState, "frame 1 board");
+    ok &= check(data.redPiecesOnBoard.count == 1 && data.bluePiecesOnBoard.count == 0, "frame 1 pieces");
+    ok &= check(!reader.poll(data), "poll with nothing new");
+
+    // Frame 2 reuses the same ImageState, must not carry over frame 1
+    redClusters.clear();
+    blueClusters = {makeCluster(150, 50)};
+    state.isValidState = state.generateBoardState(redClusters, blueClusters);
+    ok &= check(publisher.publish(state, StatePublisher::now()), "publish frame 2");
+    ok &= check(reader.poll(data), "poll frame 2");
+    ok &= check(std::string(data.boardState) == state.boardState, "frame 2 board");
+    ok &= check(data.redPiecesOnBoard.count == 0 && data.bluePiecesOnBoard.count == 1, "frame 2 pieces");
+
+    // Frame 3, more off board pieces than fit in the list
+    redClusters.clear();
+    blueClusters.clear();
+    for(int i = 0; i < SHARED_STATE_MAX_PIECES + 8; i++) {
+        redClusters.push_back(makeCluster(900, 10 * i));
+    }
+    state.isValidState = state.generateBoardState(redClusters, blueClusters);
+    ok &= check(publisher.publish(state, StatePublisher::now()), "publish frame 3");
+    ok &= check(reader.poll(data), "poll frame 3");
+    ok &= check(data.redPiecesOffBoard.count == SHARED_STATE_MAX_PIECES, "frame 3 stored pieces");
+    ok &= check(data.redPiecesOffBoard.total == SHARED_STATE_MAX_PIECES + 8, "frame 3 total pieces");
+
+    // Malformed board string is rejected
+    state.boardState += "extra";
+    ok &= check(!publisher.publish(state, StatePublisher::now()), "reject malformed board");
+    ok &= check(!reader.poll(data), "nothing published for malformed board");
+
+    // Only one publisher at a time
+    StatePublisher second;
+    ok &= check(!second.open(TEST_SHM_NAME), "second publisher refused");
+
+    // Reader follows the region when the publisher unlinks and a new one starts
+    publisher.close(true);
+    ok &= check(second.open(TEST_SHM_NAME), "new publisher after unlink");
+    state.isValidState = state.generateBoardState(redClusters, blueClusters);
+    ok &= check(second.publish(state, StatePublisher::now()), "publish to new region");
+    ok &= check(reader.poll(data), "poll new region");
+    ok &= check(data.sequence == 1, "new region sequence");
+    second.close(true);
+
+    if(ok) {
+        std::cout << "All state sharing checks passed\n";
+    }
+    return ok ? 0 : 1;
+}
@@ -13,6 +13,7 @@
 #include <vector>
 #include <opencv2/opencv.hpp>
 #include "PieceRecognition.h"
+#include "StatePublisher.h"
 
 int testClusterizing(int argc, char** argv) {
     // Check arguments
@@ -117,8 +118,44 @@ int testBoardString(int argc, char** argv) {
     return 0;
 }
 
+int testStatePublisher(int argc, char** argv) {
+    // Check arguments
+    if(argc != 3) {
+        std::cout << "Must use exactly 2 arguments, the align file path and the image file path\n";
+        return 0;
+    }
+    // Read images
+    std::string alignFilename = argv[1];
+    std::string stateFilename = argv[2];
+    cv::Mat alignImg = cv::imread(alignFilename);
+    if(alignImg.empty()) {
+        std::cout << "Could not read file: " << alignFilename << "\n"; 
+        return 0;
+    }
+    // Take the frame timestamp when the image is captured, not when it is published
+    int64_t frameTime = StatePublisher::now();
+    cv::Mat stateImg = cv::imread(stateFilename);
+    if(stateImg.empty()) {
+        std::cout << "Could not read file: " << stateFilename << "\n"; 
+        return 0;
+    }
+    // Align board and get board state
+    ImageState boardState;
+    boardState.alignCamera(alignImg);
+    boardState.generateBoardstate(stateImg);
+    // Publish to shared memory, left in place for readers after exit
+    StatePublisher publisher;
+    if(!publisher.open()) {
+        return 0;
+    }
+    publisher.publish(boardState, frameTime);
+    std::cout << "Published state " << publisher.sequence << " to " << SHARED_STATE_DEFAULT_NAME << "\n";
+    return 0;
+}
+
 int main(int argc, char** argv) {
     //return testBoardAligner(argc, argv);
     //return testClusterizing(argc, argv);
+    //return testStatePublisher(argc, argv);
     return testBoardString(argc, argv);
 }